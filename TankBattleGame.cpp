@@ -1,8 +1,877 @@
+// TankBattleGlobals.h - Process-wide gameplay switches
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Misc/CommandLine.h"
+#include "Components/ActorComponent.h"
+
+namespace TankBattle
+{
+    // True on dedicated servers and headless simulation runs (-TankSimulation).
+    // Gates emitter/sound calls and strips cosmetic components from spawned actors.
+    // Server builds never construct those components at all, see TankCosmeticComponents.h.
+    inline bool ShouldSkipEffects()
+    {
+        static const bool bSkipEffects = IsRunningDedicatedServer()
+            || FParse::Param(FCommandLine::Get(), TEXT("TankSimulation"));
+        return bSkipEffects;
+    }
+
+    // Destroys a cosmetic component of an actor instance before it registers. Used by
+    // headless runs of a client binary, whose class templates still carry the component.
+    template <typename T>
+    void StripCosmeticComponent(T*& Component)
+    {
+        if (Component)
+        {
+            Component->DestroyComponent();
+            Component = nullptr;
+        }
+    }
+}
+
+// TankBattleGlobals.cpp
+#include "TankBattleGlobals.h"
+#include "HAL/IConsoleManager.h"
+#include "Misc/App.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogTankBattle, Log, All);
+
+namespace
+{
+    // Spawns Count actors of the given class, reports spawn time and the memory held by
+    // each actor and its components, then destroys them again
+    void MeasureSpawns(UWorld* World, UClass* ActorClass, int32 Count)
+    {
+        FActorSpawnParameters SpawnParams;
+        SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+
+        TArray<AActor*> Spawned;
+        Spawned.Reserve(Count);
+
+        uint64 UsedBefore = FPlatformMemory::GetStats().UsedPhysical;
+        double StartTime = FPlatformTime::Seconds();
+        for (int32 Index = 0; Index < Count; ++Index)
+        {
+            FVector Location(Index * 500.0f, 0.0f, 100000.0f);
+            Spawned.Add(World->SpawnActor(ActorClass, &Location, nullptr, SpawnParams));
+        }
+        double Elapsed = FPlatformTime::Seconds() - StartTime;
+        int64 UsedDelta = (int64)FPlatformMemory::GetStats().UsedPhysical - (int64)UsedBefore;
+
+        SIZE_T ObjectBytes = 0;
+        int32 Components = 0;
+        for (AActor* Actor : Spawned)
+        {
+            if (!Actor) continue;
+
+            ObjectBytes += Actor->GetClass()->GetStructureSize();
+            for (UActorComponent* Component : Actor->GetComponents())
+            {
+                ObjectBytes += Component->GetClass()->GetStructureSize()
+                    + Component->GetResourceSizeBytes(EResourceSizeMode::Exclusive);
+                ++Components;
+            }
+            Actor->Destroy();
+        }
+
+        UE_LOG(LogTankBattle, Display,
+               TEXT("%s x%d: %.1f us per spawn, %d components each, %llu object bytes each, %lld bytes process delta each"),
+               *ActorClass->GetName(), Count, Elapsed * 1e6 / Count, Components / FMath::Max(Count, 1),
+               (uint64)(ObjectBytes / FMath::Max(Count, 1)), UsedDelta / FMath::Max(Count, 1));
+    }
+}
+
+// Compares the cost of the cosmetic components per actor. Pass the Blueprint classes the
+// game actually spawns, since only those carry meshes, particle templates and archetypes,
+// and run the same command in a client and a server build, e.g.
+//   -nullrhi -ExecCmds="Tank.BenchSpawn 500 /Game/Blueprints/BP_PlayerTank.BP_PlayerTank_C"
+static FAutoConsoleCommandWithWorldAndArgs BenchSpawnCommand(
+    TEXT("Tank.BenchSpawn"),
+    TEXT("Tank.BenchSpawn [Count] ClassPath... - Measures spawn time and memory per actor of each class"),
+    FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World)
+    {
+        if (!World) return;
+
+        int32 Count = 500;
+        TArray<UClass*> ActorClasses;
+        for (const FString& Arg : Args)
+        {
+            if (Arg.IsNumeric())
+            {
+                Count = FMath::Max(FCString::Atoi(*Arg), 1);
+            }
+            else if (UClass* ActorClass = LoadClass<AActor>(nullptr, *Arg))
+            {
+                ActorClasses.Add(ActorClass);
+            }
+            else
+            {
+                UE_LOG(LogTankBattle, Warning, TEXT("Tank.BenchSpawn: could not load actor class %s"), *Arg);
+            }
+        }
+
+        if (ActorClasses.Num() == 0)
+        {
+            UE_LOG(LogTankBattle, Warning, TEXT("Usage: Tank.BenchSpawn [Count] ClassPath..."));
+            return;
+        }
+
+        UE_LOG(LogTankBattle, Display, TEXT("Tank.BenchSpawn: %s build, %s RHI, effects %s"),
+               UE_SERVER ? TEXT("server") : TEXT("client"),
+               FApp::CanEverRender() ? TEXT("rendering") : TEXT("null"),
+               TankBattle::ShouldSkipEffects() ? TEXT("skipped") : TEXT("enabled"));
+
+        for (UClass* ActorClass : ActorClasses)
+        {
+            MeasureSpawns(World, ActorClass, Count);
+        }
+    }));
+
+// TankCosmeticComponents.h - Purely visual components that dedicated servers never load
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameFramework/SpringArmComponent.h"
+#include "Camera/CameraComponent.h"
+#include "Components/StaticMeshComponent.h"
+#include "Particles/ParticleSystemComponent.h"
+#include "TankCosmeticComponents.generated.h"
+
+// Server builds compile these components out of the actor constructors, so the native
+// class templates lack them there. Reporting them as not needed for the server makes
+// the server cook and loader drop the overrides Blueprints saved for them, instead of
+// loading subobjects the server templates no longer have.
+
+UCLASS()
+class TANKBATTLE_API UTankSpringArmComponent : public USpringArmComponent
+{
+    GENERATED_BODY()
+
+public:
+    virtual bool NeedsLoadForServer() const override;
+};
+
+UCLASS()
+class TANKBATTLE_API UTankCameraComponent : public UCameraComponent
+{
+    GENERATED_BODY()
+
+public:
+    virtual bool NeedsLoadForServer() const override;
+};
+
+UCLASS()
+class TANKBATTLE_API UTankCosmeticMeshComponent : public UStaticMeshComponent
+{
+    GENERATED_BODY()
+
+public:
+    virtual bool NeedsLoadForServer() const override;
+};
+
+UCLASS()
+class TANKBATTLE_API UTankTrailComponent : public UParticleSystemComponent
+{
+    GENERATED_BODY()
+
+public:
+    virtual bool NeedsLoadForServer() const override;
+};
+
+// TankCosmeticComponents.cpp
+#include "TankCosmeticComponents.h"
+
+bool UTankSpringArmComponent::NeedsLoadForServer() const
+{
+    return false;
+}
+
+bool UTankCameraComponent::NeedsLoadForServer() const
+{
+    return false;
+}
+
+bool UTankCosmeticMeshComponent::NeedsLoadForServer() const
+{
+    return false;
+}
+
+bool UTankTrailComponent::NeedsLoadForServer() const
+{
+    return false;
+}
+
+// TankTelemetry.h - Per-match gameplay telemetry stream
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HAL/Runnable.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "UObject/UObjectArray.h"
+#include "Engine/World.h"
+#include <atomic>
+#include "TankTelemetry.generated.h"
+
+DECLARE_LOG_CATEGORY_EXTERN(LogTankTelemetry, Log, All);
+
+enum class ETelemetryEventType : uint8
+{
+    ShotFired,
+    Hit,
+    Damage,
+    Kill,
+    ObstacleDestroyed,
+    AIStateChange
+};
+
+// Stored in the Detail column of Hit events
+enum class ETelemetryTargetKind : uint8
+{
+    Other,
+    Tank,
+    Obstacle
+};
+
+struct FTelemetryEvent
+{
+    float Time;
+    uint32 WorldId;
+    uint32 SourceId;
+    uint32 TargetId;
+    float Value;
+    ETelemetryEventType Type;
+    uint8 Detail;
+};
+
+// Bounded lock-free ring buffer, many producers and a single consumer.
+// Producers never block: when the buffer is full the event is dropped and counted.
+class FTelemetryRingBuffer
+{
+public:
+    static constexpr uint64 Capacity = 1 << 16;
+
+    FTelemetryRingBuffer();
+
+    bool Push(const FTelemetryEvent& Event);
+    bool Pop(FTelemetryEvent& OutEvent);
+    uint64 GetDroppedCount() const { return Dropped.load(std::memory_order_relaxed); }
+
+private:
+    struct FSlot
+    {
+        std::atomic<uint64> Sequence;
+        FTelemetryEvent Event;
+    };
+
+    TUniquePtr<FSlot[]> Slots;
+
+    // Kept on separate cache lines so producers and the consumer do not false-share
+    alignas(PLATFORM_CACHE_LINE_SIZE) std::atomic<uint64> EnqueuePos{0};
+    alignas(PLATFORM_CACHE_LINE_SIZE) std::atomic<uint64> Dropped{0};
+    alignas(PLATFORM_CACHE_LINE_SIZE) uint64 DequeuePos = 0;
+};
+
+// Background thread draining the ring buffer into a columnar file
+class FTelemetryWriter : public FRunnable
+{
+public:
+    static constexpr uint32 FileMagic = 0x4D544B54; // "TKTM"
+    static constexpr uint32 FileVersion = 3;
+
+    FTelemetryWriter(FTelemetryRingBuffer& InBuffer, const FString& FilePath);
+    virtual ~FTelemetryWriter();
+
+    virtual uint32 Run() override;
+    virtual void Stop() override;
+
+private:
+    static constexpr int32 MaxBlockSize = 4096;
+
+    void Drain();
+    void WriteBlock();
+
+    FTelemetryRingBuffer& Buffer;
+    TUniquePtr<class IFileHandle> File;
+    FRunnableThread* Thread = nullptr;
+    std::atomic<bool> bStopRequested{false};
+
+    // Column staging for the block being built
+    TArray<float> Times;
+    TArray<uint32> WorldIds;
+    TArray<uint32> SourceIds;
+    TArray<uint32> TargetIds;
+    TArray<float> Values;
+    TArray<uint8> Types;
+    TArray<uint8> Details;
+};
+
+// Game-facing entry point. Emit is cheap enough to call from any gameplay hot path.
+// The stream is shared by every game world in the process: the first BeginMatch opens
+// the file and the matching last EndMatch closes it. Each world keeps its own clock,
+// so every event carries the id of the world it happened in and times are only
+// comparable within one world.
+class TANKBATTLE_API FTankTelemetry
+{
+public:
+    static void BeginMatch(const FString& FilePath);
+    static void EndMatch();
+
+    // Time is in the world's game time; shots fired within a frame pass their own
+    static FORCEINLINE void Emit(ETelemetryEventType Type, const UWorld* World, float Time, const UObject* Source,
+                                 const UObject* Target = nullptr, float Value = 0.0f, uint8 Detail = 0)
+    {
+        // Announce the producer before reading the buffer pointer, so EndMatch cannot
+        // free the buffer while this push is still in flight
+        ActiveProducers.fetch_add(1);
+        if (FTelemetryRingBuffer* Buffer = ActiveBuffer.load())
+        {
+            Buffer->Push({ Time, GetId(World), GetId(Source), GetId(Target), Value, Type, Detail });
+        }
+        ActiveProducers.fetch_sub(1, std::memory_order_release);
+    }
+
+private:
+    // Object serial numbers increase monotonically and are never reused, unlike the
+    // GUObjectArray slot returned by GetUniqueID
+    static FORCEINLINE uint32 GetId(const UObject* Object)
+    {
+        return Object ? (uint32)GUObjectArray.AllocateSerialNumber(GUObjectArray.ObjectToIndex(Object)) : 0u;
+    }
+
+    static std::atomic<FTelemetryRingBuffer*> ActiveBuffer;
+    static std::atomic<int32> ActiveProducers;
+    static TUniquePtr<FTelemetryRingBuffer> Buffer;
+    static TUniquePtr<FTelemetryWriter> Writer;
+    static int32 MatchCount;
+};
+
+// Starts a telemetry stream when a game world begins play and closes it with the world
+UCLASS()
+class TANKBATTLE_API UTankTelemetrySubsystem : public UWorldSubsystem
+{
+    GENERATED_BODY()
+
+public:
+    virtual void OnWorldBeginPlay(UWorld& InWorld) override;
+    virtual void Deinitialize() override;
+
+protected:
+    virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+private:
+    bool bMatchStarted = false;
+};
+
+// TankTelemetry.cpp
+#include "TankTelemetry.h"
+#include "HAL/RunnableThread.h"
+#include "HAL/PlatformFileManager.h"
+#include "GenericPlatform/GenericPlatformFile.h"
+#include "Misc/Paths.h"
+#include "Misc/DateTime.h"
+
+DEFINE_LOG_CATEGORY(LogTankTelemetry);
+
+std::atomic<FTelemetryRingBuffer*> FTankTelemetry::ActiveBuffer{nullptr};
+std::atomic<int32> FTankTelemetry::ActiveProducers{0};
+TUniquePtr<FTelemetryRingBuffer> FTankTelemetry::Buffer;
+TUniquePtr<FTelemetryWriter> FTankTelemetry::Writer;
+int32 FTankTelemetry::MatchCount = 0;
+
+FTelemetryRingBuffer::FTelemetryRingBuffer()
+    : Slots(MakeUnique<FSlot[]>(Capacity))
+{
+    for (uint64 Index = 0; Index < Capacity; ++Index)
+    {
+        Slots[Index].Sequence.store(Index, std::memory_order_relaxed);
+    }
+}
+
+bool FTelemetryRingBuffer::Push(const FTelemetryEvent& Event)
+{
+    uint64 Pos = EnqueuePos.load(std::memory_order_relaxed);
+    FSlot* Slot;
+
+    for (;;)
+    {
+        Slot = &Slots[Pos & (Capacity - 1)];
+        int64 Diff = (int64)Slot->Sequence.load(std::memory_order_acquire) - (int64)Pos;
+
+        if (Diff == 0)
+        {
+            if (EnqueuePos.compare_exchange_weak(Pos, Pos + 1, std::memory_order_relaxed))
+            {
+                break;
+            }
+        }
+        else if (Diff < 0)
+        {
+            // Consumer has not freed this slot yet, the buffer is full
+            Dropped.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+        else
+        {
+            Pos = EnqueuePos.load(std::memory_order_relaxed);
+        }
+    }
+
+    Slot->Event = Event;
+    Slot->Sequence.store(Pos + 1, std::memory_order_release);
+    return true;
+}
+
+bool FTelemetryRingBuffer::Pop(FTelemetryEvent& OutEvent)
+{
+    FSlot& Slot = Slots[DequeuePos & (Capacity - 1)];
+    if (Slot.Sequence.load(std::memory_order_acquire) != DequeuePos + 1) return false;
+
+    OutEvent = Slot.Event;
+    Slot.Sequence.store(DequeuePos + Capacity, std::memory_order_release);
+    ++DequeuePos;
+    return true;
+}
+
+FTelemetryWriter::FTelemetryWriter(FTelemetryRingBuffer& InBuffer, const FString& FilePath)
+    : Buffer(InBuffer)
+{
+    IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
+    PlatformFile.CreateDirectoryTree(*FPaths::GetPath(FilePath));
+    File.Reset(PlatformFile.OpenWrite(*FilePath));
+
+    if (!File)
+    {
+        UE_LOG(LogTankTelemetry, Warning, TEXT("Could not open telemetry file %s"), *FilePath);
+        return;
+    }
+
+    File->Write(reinterpret_cast<const uint8*>(&FileMagic), sizeof(FileMagic));
+    File->Write(reinterpret_cast<const uint8*>(&FileVersion), sizeof(FileVersion));
+
+    Thread = FRunnableThread::Create(this, TEXT("TankTelemetryWriter"), 0, TPri_BelowNormal);
+}
+
+FTelemetryWriter::~FTelemetryWriter()
+{
+    if (Thread)
+    {
+        Stop();
+        Thread->WaitForCompletion();
+        delete Thread;
+    }
+}
+
+uint32 FTelemetryWriter::Run()
+{
+    while (!bStopRequested.load(std::memory_order_relaxed))
+    {
+        Drain();
+        FPlatformProcess::Sleep(0.05f);
+    }
+
+    // Pick up anything pushed before the stop request
+    Drain();
+    File->Flush();
+    return 0;
+}
+
+void FTelemetryWriter::Stop()
+{
+    bStopRequested.store(true, std::memory_order_relaxed);
+}
+
+void FTelemetryWriter::Drain()
+{
+    FTelemetryEvent Event;
+    while (Buffer.Pop(Event))
+    {
+        Times.Add(Event.Time);
+        WorldIds.Add(Event.WorldId);
+        SourceIds.Add(Event.SourceId);
+        TargetIds.Add(Event.TargetId);
+        Values.Add(Event.Value);
+        Types.Add((uint8)Event.Type);
+        Details.Add(Event.Detail);
+
+        if (Times.Num() == MaxBlockSize)
+        {
+            WriteBlock();
+        }
+    }
+
+    if (Times.Num() > 0)
+    {
+        WriteBlock();
+    }
+}
+
+void FTelemetryWriter::WriteBlock()
+{
+    // Block layout: count, drops so far, then one contiguous array per column
+    uint32 Count = Times.Num();
+    uint64 DroppedSoFar = Buffer.GetDroppedCount();
+
+    File->Write(reinterpret_cast<const uint8*>(&Count), sizeof(Count));
+    File->Write(reinterpret_cast<const uint8*>(&DroppedSoFar), sizeof(DroppedSoFar));
+    File->Write(reinterpret_cast<const uint8*>(Times.GetData()), Count * sizeof(float));
+    File->Write(reinterpret_cast<const uint8*>(WorldIds.GetData()), Count * sizeof(uint32));
+    File->Write(reinterpret_cast<const uint8*>(SourceIds.GetData()), Count * sizeof(uint32));
+    File->Write(reinterpret_cast<const uint8*>(TargetIds.GetData()), Count * sizeof(uint32));
+    File->Write(reinterpret_cast<const uint8*>(Values.GetData()), Count * sizeof(float));
+    File->Write(Types.GetData(), Count);
+    File->Write(Details.GetData(), Count);
+
+    Times.Reset();
+    WorldIds.Reset();
+    SourceIds.Reset();
+    TargetIds.Reset();
+    Values.Reset();
+    Types.Reset();
+    Details.Reset();
+}
+
+void FTankTelemetry::BeginMatch(const FString& FilePath)
+{
+    check(IsInGameThread());
+    if (MatchCount++ > 0) return;
+
+    Buffer = MakeUnique<FTelemetryRingBuffer>();
+    Writer = MakeUnique<FTelemetryWriter>(*Buffer, FilePath);
+    ActiveBuffer.store(Buffer.Get());
+}
+
+void FTankTelemetry::EndMatch()
+{
+    check(IsInGameThread() && MatchCount > 0);
+    if (--MatchCount > 0) return;
+
+    ActiveBuffer.store(nullptr);
+
+    // Producers that read the old pointer may still be pushing into it
+    while (ActiveProducers.load() != 0)
+    {
+        FPlatformProcess::YieldThread();
+    }
+
+    if (Buffer->GetDroppedCount() > 0)
+    {
+        UE_LOG(LogTankTelemetry, Warning, TEXT("Telemetry dropped %llu events"), Buffer->GetDroppedCount());
+    }
+
+    // Writer drains the remaining events before its thread exits
+    Writer.Reset();
+    Buffer.Reset();
+}
+
+void UTankTelemetrySubsystem::OnWorldBeginPlay(UWorld& InWorld)
+{
+    Super::OnWorldBeginPlay(InWorld);
+
+    FString FileName = FString::Printf(TEXT("Match_%s.tktm"), *FDateTime::Now().ToString());
+    FTankTelemetry::BeginMatch(FPaths::ProjectSavedDir() / TEXT("Telemetry") / FileName);
+    bMatchStarted = true;
+}
+
+void UTankTelemetrySubsystem::Deinitialize()
+{
+    if (bMatchStarted)
+    {
+        FTankTelemetry::EndMatch();
+        bMatchStarted = false;
+    }
+    Super::Deinitialize();
+}
+
+bool UTankTelemetrySubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+    return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+// TankArchetype.h - Shared tuning data for a kind of tank
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/DataAsset.h"
+#include "TankArchetype.generated.h"
+
+DECLARE_MULTICAST_DELEGATE_OneParam(FOnTankArchetypeChanged, const class UTankArchetype*);
+
+// Immutable at runtime and shared by every tank of the same kind. Tanks without an
+// archetype asset get a transient one built from their legacy tuning fields.
+UCLASS(BlueprintType)
+class TANKBATTLE_API UTankArchetype : public UPrimaryDataAsset
+{
+    GENERATED_BODY()
+
+public:
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Tank Properties")
+    float MaxHealth = 100.0f;
+
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Tank Properties")
+    float MoveSpeed = 400.0f;
+
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Tank Properties")
+    float TurnRate = 100.0f;
+
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Tank Properties")
+    float TurretRotationSpeed = 5.0f;
+
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Combat")
+    float FireRate = 2.0f;
+
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Combat")
+    TSubclassOf<class AProjectile> ProjectileClass;
+
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "AI")
+    float DetectionRange = 1500.0f;
+
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "AI")
+    float AttackRange = 800.0f;
+
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "AI")
+    float PatrolRadius = 1000.0f;
+
+    // Fired when a designer edits an archetype so live tanks pick up the new values
+    static FOnTankArchetypeChanged OnArchetypeChanged;
+
+    bool HasSameTuning(const UTankArchetype& Other) const;
+    void CopyTuning(const UTankArchetype& Source);
+
+#if WITH_EDITOR
+    virtual void PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent) override;
+#endif
+};
+
+// TankArchetype.cpp
+#include "TankArchetype.h"
+
+FOnTankArchetypeChanged UTankArchetype::OnArchetypeChanged;
+
+bool UTankArchetype::HasSameTuning(const UTankArchetype& Other) const
+{
+    return MaxHealth == Other.MaxHealth
+        && MoveSpeed == Other.MoveSpeed
+        && TurnRate == Other.TurnRate
+        && TurretRotationSpeed == Other.TurretRotationSpeed
+        && FireRate == Other.FireRate
+        && ProjectileClass == Other.ProjectileClass
+        && DetectionRange == Other.DetectionRange
+        && AttackRange == Other.AttackRange
+        && PatrolRadius == Other.PatrolRadius;
+}
+
+void UTankArchetype::CopyTuning(const UTankArchetype& Source)
+{
+    MaxHealth = Source.MaxHealth;
+    MoveSpeed = Source.MoveSpeed;
+    TurnRate = Source.TurnRate;
+    TurretRotationSpeed = Source.TurretRotationSpeed;
+    FireRate = Source.FireRate;
+    ProjectileClass = Source.ProjectileClass;
+    DetectionRange = Source.DetectionRange;
+    AttackRange = Source.AttackRange;
+    PatrolRadius = Source.PatrolRadius;
+}
+
+#if WITH_EDITOR
+void UTankArchetype::PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent)
+{
+    Super::PostEditChangeProperty(PropertyChangedEvent);
+    OnArchetypeChanged.Broadcast(this);
+}
+#endif
+
+// TankStateSubsystem.h - Archetype table and densely packed per-tank state
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "TankStateSubsystem.generated.h"
+
+class ATankBase;
+class UTankArchetype;
+
+// Hot per-tank state is stored as parallel arrays indexed by a tank's state index,
+// so batched passes stream through only the fields they need. Removal swaps the
+// last tank into the freed slot.
+UCLASS()
+class TANKBATTLE_API UTankStateSubsystem : public UWorldSubsystem
+{
+    GENERATED_BODY()
+
+public:
+    virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+    virtual void Deinitialize() override;
+
+    int32 AddTank(ATankBase* Tank, const UTankArchetype* Archetype);
+    void RemoveTank(int32 StateIndex);
+
+    // Shared transient archetype matching a tank's legacy per-instance tuning fields
+    const UTankArchetype* FindOrAddLegacyArchetype(const ATankBase& Tank);
+
+    const UTankArchetype& GetArchetype(int32 StateIndex) const { return *Archetypes[ArchetypeIndices[StateIndex]]; }
+    int32 Num() const { return Tanks.Num(); }
+
+    // Copies every tank's actor location into Positions. Tanks move after their own
+    // tick (AI path following, physics), so batched passes call this first.
+    void RefreshPositions();
+
+    // Dense state, one entry per registered tank
+    TArray<float> CurrentHealth;
+    TArray<float> LastFireTime;
+    TArray<uint8> AIStates;
+    TArray<FVector> Positions;
+    TArray<uint16> ArchetypeIndices;
+
+    UPROPERTY()
+    TArray<ATankBase*> Tanks;
+
+private:
+    int32 FindOrAddArchetype(const UTankArchetype* Archetype);
+    void HandleArchetypeChanged(const UTankArchetype* Archetype);
+
+    UPROPERTY()
+    TArray<const UTankArchetype*> Archetypes;
+
+    UPROPERTY()
+    TArray<UTankArchetype*> LegacyArchetypes;
+
+    // Filled from a tank's legacy fields for the lookup, and only kept as a new shared
+    // archetype when none of LegacyArchetypes matches
+    UPROPERTY()
+    UTankArchetype* LegacyScratch = nullptr;
+
+    // Max health each archetype had when last seen, used to rescale health on edits
+    TArray<float> ArchetypeMaxHealth;
+
+    FDelegateHandle ArchetypeChangedHandle;
+};
+
+// TankStateSubsystem.cpp
+#include "TankStateSubsystem.h"
+#include "TankArchetype.h"
+#include "TankBase.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogTankState, Log, All);
+
+void UTankStateSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+    Super::Initialize(Collection);
+    ArchetypeChangedHandle = UTankArchetype::OnArchetypeChanged.AddUObject(
+        this, &UTankStateSubsystem::HandleArchetypeChanged);
+}
+
+void UTankStateSubsystem::Deinitialize()
+{
+    UTankArchetype::OnArchetypeChanged.Remove(ArchetypeChangedHandle);
+    Super::Deinitialize();
+}
+
+int32 UTankStateSubsystem::AddTank(ATankBase* Tank, const UTankArchetype* Archetype)
+{
+    int32 ArchetypeIndex = FindOrAddArchetype(Archetype);
+
+    Tanks.Add(Tank);
+    CurrentHealth.Add(Archetype->MaxHealth);
+    LastFireTime.Add(0.0f);
+    AIStates.Add(0);
+    Positions.Add(Tank->GetActorLocation());
+    ArchetypeIndices.Add((uint16)ArchetypeIndex);
+
+    return Tanks.Num() - 1;
+}
+
+void UTankStateSubsystem::RemoveTank(int32 StateIndex)
+{
+    if (!Tanks.IsValidIndex(StateIndex)) return;
+
+    Tanks.RemoveAtSwap(StateIndex, 1, false);
+    CurrentHealth.RemoveAtSwap(StateIndex, 1, false);
+    LastFireTime.RemoveAtSwap(StateIndex, 1, false);
+    AIStates.RemoveAtSwap(StateIndex, 1, false);
+    Positions.RemoveAtSwap(StateIndex, 1, false);
+    ArchetypeIndices.RemoveAtSwap(StateIndex, 1, false);
+
+    // The tank moved into the freed slot needs its new index
+    if (Tanks.IsValidIndex(StateIndex))
+    {
+        Tanks[StateIndex]->StateIndex = StateIndex;
+    }
+}
+
+int32 UTankStateSubsystem::FindOrAddArchetype(const UTankArchetype* Archetype)
+{
+    int32 Index = Archetypes.Find(Archetype);
+    if (Index == INDEX_NONE)
+    {
+        Index = Archetypes.Add(Archetype);
+        ArchetypeMaxHealth.Add(Archetype->MaxHealth);
+    }
+    return Index;
+}
+
+void UTankStateSubsystem::RefreshPositions()
+{
+    for (int32 Index = 0; Index < Tanks.Num(); ++Index)
+    {
+        Positions[Index] = Tanks[Index]->GetActorLocation();
+    }
+}
+
+const UTankArchetype* UTankStateSubsystem::FindOrAddLegacyArchetype(const ATankBase& Tank)
+{
+    if (!LegacyScratch)
+    {
+        LegacyScratch = NewObject<UTankArchetype>(this, NAME_None, RF_Transient);
+    }
+
+    // Fields a tank class has no legacy value for keep the archetype defaults
+    LegacyScratch->CopyTuning(*GetDefault<UTankArchetype>());
+    Tank.CopyLegacyTuning(*LegacyScratch);
+
+    // Tanks with identical tuning share one archetype
+    for (UTankArchetype* Existing : LegacyArchetypes)
+    {
+        if (Existing->HasSameTuning(*LegacyScratch))
+        {
+            return Existing;
+        }
+    }
+
+    UE_LOG(LogTankState, Warning, TEXT("%s has no Archetype asset, using one built from its legacy tuning fields"),
+           *Tank.GetName());
+    UTankArchetype* Legacy = LegacyScratch;
+    LegacyScratch = nullptr;
+    LegacyArchetypes.Add(Legacy);
+    return Legacy;
+}
+
+void UTankStateSubsystem::HandleArchetypeChanged(const UTankArchetype* Archetype)
+{
+    int32 ArchetypeIndex = Archetypes.Find(Archetype);
+    if (ArchetypeIndex == INDEX_NONE) return;
+
+    // Keep each tank at the same fraction of its max health
+    float OldMaxHealth = ArchetypeMaxHealth[ArchetypeIndex];
+    float Scale = OldMaxHealth > 0.0f ? Archetype->MaxHealth / OldMaxHealth : 1.0f;
+    ArchetypeMaxHealth[ArchetypeIndex] = Archetype->MaxHealth;
+
+    for (int32 Index = 0; Index < Tanks.Num(); ++Index)
+    {
+        if (ArchetypeIndices[Index] == ArchetypeIndex)
+        {
+            CurrentHealth[Index] = FMath::Min(CurrentHealth[Index] * Scale, Archetype->MaxHealth);
+        }
+    }
+}
+
 // TankBase.h - Base class for all tanks
 #pragma once
 
 #include "CoreMinimal.h"
 #include "GameFramework/Pawn.h"
+#include "TankBattleGlobals.h"
 #include "TankBase.generated.h"
 
 UCLASS()
@@ -15,6 +884,7 @@ public:
 
 protected:
     virtual void BeginPlay() override;
+    virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
 
     // Components
     UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Components")
@@ -32,30 +902,47 @@ protected:
     UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Components")
     class USceneComponent* ProjectileSpawnPoint;
 
-    // Tank Properties
-    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Tank Properties")
-    float MaxHealth = 100.0f;
+    // Tank Properties, shared with every tank of the same archetype
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Tank Properties")
+    class UTankArchetype* Archetype;
 
-    UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Tank Properties")
-    float CurrentHealth;
+    // Legacy per-instance tuning, kept so existing Blueprints and placed tanks load and
+    // compile unchanged. Only read at BeginPlay to build an archetype when Archetype is
+    // not set; Blueprint access is deprecated in favour of the archetype and the getters.
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Tank Properties|Legacy", meta = (EditCondition = "Archetype == nullptr", DeprecatedProperty, DeprecationMessage = "Set tuning on a TankArchetype asset; this field is only read at BeginPlay when no Archetype is set."))
+    float MaxHealth = 100.0f;
 
-    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Tank Properties")
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Tank Properties|Legacy", meta = (EditCondition = "Archetype == nullptr", DeprecatedProperty, DeprecationMessage = "Set tuning on a TankArchetype asset; this field is only read at BeginPlay when no Archetype is set."))
     float MoveSpeed = 400.0f;
 
-    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Tank Properties")
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Tank Properties|Legacy", meta = (EditCondition = "Archetype == nullptr", DeprecatedProperty, DeprecationMessage = "Set tuning on a TankArchetype asset; this field is only read at BeginPlay when no Archetype is set."))
     float TurnRate = 100.0f;
 
-    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Tank Properties")
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Tank Properties|Legacy", meta = (EditCondition = "Archetype == nullptr", DeprecatedProperty, DeprecationMessage = "Set tuning on a TankArchetype asset; this field is only read at BeginPlay when no Archetype is set."))
     float TurretRotationSpeed = 5.0f;
 
-    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Combat")
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Tank Properties|Legacy", meta = (EditCondition = "Archetype == nullptr", DeprecatedProperty, DeprecationMessage = "Set tuning on a TankArchetype asset; this field is only read at BeginPlay when no Archetype is set."))
     float FireRate = 2.0f;
 
-    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Combat")
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Tank Properties|Legacy", meta = (EditCondition = "Archetype == nullptr", DeprecatedProperty, DeprecationMessage = "Set tuning on a TankArchetype asset; this field is only read at BeginPlay when no Archetype is set."))
     TSubclassOf<class AProjectile> ProjectileClass;
 
+    virtual void CopyLegacyTuning(UTankArchetype& OutArchetype) const;
+
+    // Hot state lives in the world's tank state store. A tank owns a slot only between
+    // BeginPlay and EndPlay; every entry point checks HasTankState before touching it,
+    // since damage and AI calls can still reach a tank that has been destroyed.
+    UPROPERTY(Transient)
+    class UTankStateSubsystem* TankStates;
+
+    int32 StateIndex = INDEX_NONE;
+
+    bool HasTankState() const { return TankStates != nullptr; }
+    const UTankArchetype& GetArchetype() const;
+
     // Combat
     virtual void Fire();
+    bool FireAt(float RequestTime);
     void RotateTurretTowards(FVector TargetLocation);
     
     // Damage System
@@ -65,12 +952,26 @@ protected:
     virtual void HandleDestruction();
 
 private:
-    float LastFireTime = 0.0f;
+    // Upper bound on shots emitted in a single frame, guards against hitches
+    static constexpr int32 MaxShotsPerFrame = 8;
+
+    int32 SpawnShots(TArrayView<const float> ShotTimes);
+
+    uint64 LastFireRequestFrame = 0;
     bool bIsDestroyed = false;
 
 public:
     virtual void Tick(float DeltaTime) override;
     bool IsDestroyed() const { return bIsDestroyed; }
+
+    // Replace the CurrentHealth property Blueprints used to read directly
+    UFUNCTION(BlueprintPure, Category = "Tank Properties")
+    float GetCurrentHealth() const;
+
+    UFUNCTION(BlueprintPure, Category = "Tank Properties")
+    float GetMaxHealth() const;
+
+    friend class UTankStateSubsystem;
 };
 
 // TankBase.cpp
@@ -79,6 +980,9 @@ public:
 #include "Components/StaticMeshComponent.h"
 #include "Components/SceneComponent.h"
 #include "Projectile.h"
+#include "TankArchetype.h"
+#include "TankStateSubsystem.h"
+#include "TankTelemetry.h"
 #include "Kismet/GameplayStatics.h"
 
 ATankBase::ATankBase()
@@ -110,7 +1014,32 @@ ATankBase::ATankBase()
 void ATankBase::BeginPlay()
 {
     Super::BeginPlay();
-    CurrentHealth = MaxHealth;
+    
+    TankStates = GetWorld()->GetSubsystem<UTankStateSubsystem>();
+    const UTankArchetype* TankArchetype = Archetype ? Archetype : TankStates->FindOrAddLegacyArchetype(*this);
+    StateIndex = TankStates->AddTank(this, TankArchetype);
+}
+
+void ATankBase::CopyLegacyTuning(UTankArchetype& OutArchetype) const
+{
+    OutArchetype.MaxHealth = MaxHealth;
+    OutArchetype.MoveSpeed = MoveSpeed;
+    OutArchetype.TurnRate = TurnRate;
+    OutArchetype.TurretRotationSpeed = TurretRotationSpeed;
+    OutArchetype.FireRate = FireRate;
+    OutArchetype.ProjectileClass = ProjectileClass;
+}
+
+void ATankBase::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+    if (TankStates)
+    {
+        TankStates->RemoveTank(StateIndex);
+        TankStates = nullptr;
+        StateIndex = INDEX_NONE;
+    }
+    
+    Super::EndPlay(EndPlayReason);
 }
 
 void ATankBase::Tick(float DeltaTime)
@@ -118,32 +1047,115 @@ void ATankBase::Tick(float DeltaTime)
     Super::Tick(DeltaTime);
 }
 
-void ATankBase::Fire()
+const UTankArchetype& ATankBase::GetArchetype() const
+{
+    check(HasTankState());
+    return TankStates->GetArchetype(StateIndex);
+}
+
+float ATankBase::GetCurrentHealth() const
 {
-    if (bIsDestroyed) return;
+    return HasTankState() ? TankStates->CurrentHealth[StateIndex] : 0.0f;
+}
+
+float ATankBase::GetMaxHealth() const
+{
+    if (HasTankState()) return GetArchetype().MaxHealth;
     
+    // Not registered yet (or already removed), fall back to what BeginPlay would use
+    return Archetype ? Archetype->MaxHealth : MaxHealth;
+}
+
+void ATankBase::Fire()
+{
+    if (bIsDestroyed || !HasTankState()) return;
+
+    const UTankArchetype& Stats = GetArchetype();
+    if (Stats.FireRate <= 0.0f) return;
+
+    UWorld* World = GetWorld();
+    float CurrentTime = World->GetTimeSeconds();
+    float FireInterval = 1.0f / Stats.FireRate;
+    float& LastFireTime = TankStates->LastFireTime[StateIndex];
+
+    // The trigger counts as held if Fire was also requested last frame. Only then are
+    // shots that fell due since the previous frame caught up; otherwise firing starts now.
+    bool bTriggerHeld = LastFireRequestFrame + 1 >= GFrameCounter;
+    LastFireRequestFrame = GFrameCounter;
+
+    if (CurrentTime - LastFireTime < FireInterval) return;
+
+    float ShotTime = CurrentTime;
+    if (bTriggerHeld)
+    {
+        ShotTime = FMath::Max(LastFireTime + FireInterval, CurrentTime - World->GetDeltaSeconds());
+    }
+
+    // Collect every shot due this frame with its exact timestamp
+    TArray<float, TInlineAllocator<MaxShotsPerFrame>> ShotTimes;
+    for (; ShotTime <= CurrentTime && ShotTimes.Num() < MaxShotsPerFrame; ShotTime += FireInterval)
+    {
+        ShotTimes.Add(ShotTime);
+    }
+
+    SpawnShots(ShotTimes);
+}
+
+bool ATankBase::FireAt(float RequestTime)
+{
+    if (bIsDestroyed || !HasTankState()) return false;
+
+    const UTankArchetype& Stats = GetArchetype();
+    if (Stats.FireRate <= 0.0f) return false;
+
+    // A single trigger pull at a known time within the current frame
     float CurrentTime = GetWorld()->GetTimeSeconds();
-    if (CurrentTime - LastFireTime < 1.0f / FireRate) return;
-    
-    if (ProjectileClass && ProjectileSpawnPoint)
+    RequestTime = FMath::Clamp(RequestTime, CurrentTime - GetWorld()->GetDeltaSeconds(), CurrentTime);
+
+    if (RequestTime - TankStates->LastFireTime[StateIndex] < 1.0f / Stats.FireRate) return false;
+
+    return SpawnShots(MakeArrayView(&RequestTime, 1)) > 0;
+}
+
+int32 ATankBase::SpawnShots(TArrayView<const float> ShotTimes)
+{
+    const UTankArchetype& Stats = GetArchetype();
+    if (!Stats.ProjectileClass || !ProjectileSpawnPoint) return 0;
+
+    UWorld* World = GetWorld();
+    float CurrentTime = World->GetTimeSeconds();
+    int32 NumSpawned = 0;
+
+    FVector SpawnLocation = ProjectileSpawnPoint->GetComponentLocation();
+    FRotator SpawnRotation = ProjectileSpawnPoint->GetComponentRotation();
+
+    FActorSpawnParameters SpawnParams;
+    SpawnParams.Owner = this;
+    SpawnParams.Instigator = this;
+
+    // Spawn the batch at the muzzle, then sweep each projectile forward by the time
+    // it has already been in flight
+    for (float Time : ShotTimes)
     {
-        FVector SpawnLocation = ProjectileSpawnPoint->GetComponentLocation();
-        FRotator SpawnRotation = ProjectileSpawnPoint->GetComponentRotation();
-        
-        AProjectile* Projectile = GetWorld()->SpawnActor<AProjectile>(
-            ProjectileClass, SpawnLocation, SpawnRotation);
-        
+        AProjectile* Projectile = World->SpawnActor<AProjectile>(
+            Stats.ProjectileClass, SpawnLocation, SpawnRotation, SpawnParams);
+
         if (Projectile)
         {
-            Projectile->SetOwner(this);
-            LastFireTime = CurrentTime;
+            TankStates->LastFireTime[StateIndex] = Time;
+            FTankTelemetry::Emit(ETelemetryEventType::ShotFired, World, Time, this);
+            ++NumSpawned;
+
+            Projectile->CatchUp(CurrentTime - Time);
         }
     }
+
+    return NumSpawned;
 }
 
 void ATankBase::RotateTurretTowards(FVector TargetLocation)
 {
-    if (!TankTurret || bIsDestroyed) return;
+    if (!TankTurret || bIsDestroyed || !HasTankState()) return;
     
     FVector Direction = TargetLocation - TankTurret->GetComponentLocation();
     Direction.Z = 0;
@@ -153,7 +1165,7 @@ void ATankBase::RotateTurretTowards(FVector TargetLocation)
     
     FRotator NewRotation = FMath::RInterpTo(
         CurrentRotation, TargetRotation, 
-        GetWorld()->GetDeltaSeconds(), TurretRotationSpeed);
+        GetWorld()->GetDeltaSeconds(), GetArchetype().TurretRotationSpeed);
     
     TankTurret->SetWorldRotation(FRotator(0, NewRotation.Yaw, 0));
 }
@@ -161,9 +1173,15 @@ void ATankBase::RotateTurretTowards(FVector TargetLocation)
 float ATankBase::TakeDamage(float DamageAmount, FDamageEvent const& DamageEvent, 
                             AController* EventInstigator, AActor* DamageCauser)
 {
+    if (!HasTankState()) return 0.0f;
+    
     float ActualDamage = Super::TakeDamage(DamageAmount, DamageEvent, EventInstigator, DamageCauser);
     
-    CurrentHealth = FMath::Clamp(CurrentHealth - ActualDamage, 0.0f, MaxHealth);
+    float& CurrentHealth = TankStates->CurrentHealth[StateIndex];
+    CurrentHealth = FMath::Clamp(CurrentHealth - ActualDamage, 0.0f, GetArchetype().MaxHealth);
+    
+    FTankTelemetry::Emit(ETelemetryEventType::Damage, GetWorld(), GetWorld()->GetTimeSeconds(),
+                         DamageCauser, this, ActualDamage);
     
     if (CurrentHealth <= 0 && !bIsDestroyed)
     {
@@ -179,6 +1197,10 @@ void ATankBase::HandleDestruction()
     SetActorHiddenInGame(true);
     SetActorTickEnabled(false);
     
+    FTankTelemetry::Emit(ETelemetryEventType::Kill, GetWorld(), GetWorld()->GetTimeSeconds(), nullptr, this);
+    
+    if (TankBattle::ShouldSkipEffects()) return;
+
     // Spawn explosion effect
     UGameplayStatics::SpawnEmitterAtLocation(
         GetWorld(), nullptr, GetActorLocation());
@@ -201,14 +1223,17 @@ public:
 
 protected:
     virtual void BeginPlay() override;
+    virtual void PreRegisterAllComponents() override;
 
     UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Components")
-    class USpringArmComponent* SpringArm;
+    class UTankSpringArmComponent* SpringArm;
 
     UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Components")
-    class UCameraComponent* Camera;
+    class UTankCameraComponent* Camera;
 
-    // Input
+    // Input. Key events reach the player controller's input stack through Slate and are
+    // consumed in the next world tick, so a fire press spawns its projectile within one
+    // world tick of arriving (TankBattle.Input.FireInputToSpawnLatency checks this).
     void MoveForward(float Value);
     void Turn(float Value);
     void RotateTurret(float Value);
@@ -227,16 +1252,17 @@ private:
 
 // PlayerTank.cpp
 #include "PlayerTank.h"
-#include "GameFramework/SpringArmComponent.h"
-#include "Camera/CameraComponent.h"
+#include "TankArchetype.h"
+#include "TankCosmeticComponents.h"
 #include "Components/InputComponent.h"
 #include "GameFramework/PlayerController.h"
 #include "DrawDebugHelpers.h"
 
 APlayerTank::APlayerTank()
 {
-    // Spring arm for camera
-    SpringArm = CreateDefaultSubobject<USpringArmComponent>(TEXT("SpringArm"));
+#if !UE_SERVER
+    // Spring arm for camera, nobody views through it on a dedicated server
+    SpringArm = CreateDefaultSubobject<UTankSpringArmComponent>(TEXT("SpringArm"));
     SpringArm->SetupAttachment(RootComponent);
     SpringArm->SetRelativeRotation(FRotator(-45.0f, 0, 0));
     SpringArm->TargetArmLength = 1000.0f;
@@ -244,8 +1270,20 @@ APlayerTank::APlayerTank()
     SpringArm->CameraLagSpeed = 2.0f;
 
     // Camera
-    Camera = CreateDefaultSubobject<UCameraComponent>(TEXT("Camera"));
+    Camera = CreateDefaultSubobject<UTankCameraComponent>(TEXT("Camera"));
     Camera->SetupAttachment(SpringArm);
+#endif
+}
+
+void APlayerTank::PreRegisterAllComponents()
+{
+    if (TankBattle::ShouldSkipEffects() && GetWorld() && GetWorld()->IsGameWorld())
+    {
+        TankBattle::StripCosmeticComponent(Camera);
+        TankBattle::StripCosmeticComponent(SpringArm);
+    }
+    
+    Super::PreRegisterAllComponents();
 }
 
 void APlayerTank::BeginPlay()
@@ -276,46 +1314,240 @@ void APlayerTank::SetupPlayerInputComponent(UInputComponent* PlayerInputComponen
 
 void APlayerTank::MoveForward(float Value)
 {
-    if (IsDestroyed()) return;
+    if (IsDestroyed() || !HasTankState()) return;
     
     FVector DeltaLocation = FVector::ZeroVector;
-    DeltaLocation.X = Value * MoveSpeed * GetWorld()->GetDeltaSeconds();
+    DeltaLocation.X = Value * GetArchetype().MoveSpeed * GetWorld()->GetDeltaSeconds();
     AddActorLocalOffset(DeltaLocation, true);
 }
 
 void APlayerTank::Turn(float Value)
 {
-    if (IsDestroyed()) return;
+    if (IsDestroyed() || !HasTankState()) return;
     
     FRotator DeltaRotation = FRotator::ZeroRotator;
-    DeltaRotation.Yaw = Value * TurnRate * GetWorld()->GetDeltaSeconds();
+    DeltaRotation.Yaw = Value * GetArchetype().TurnRate * GetWorld()->GetDeltaSeconds();
     AddActorLocalRotation(DeltaRotation, true);
 }
 
-void APlayerTank::FireInput()
-{
-    Fire();
-}
+void APlayerTank::FireInput()
+{
+    Fire();
+}
+
+FVector APlayerTank::GetMouseHitLocation()
+{
+    FHitResult HitResult;
+    if (PlayerControllerRef)
+    {
+        PlayerControllerRef->GetHitResultUnderCursor(
+            ECollisionChannel::ECC_Visibility, false, HitResult);
+        return HitResult.Location;
+    }
+    return FVector::ZeroVector;
+}
+
+void APlayerTank::HandleDestruction()
+{
+    Super::HandleDestruction();
+    SetActorHiddenInGame(true);
+    SetActorTickEnabled(false);
+}
+
+// PlayerTankInputTest.cpp - Automation test for fire input to projectile spawn latency
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "PlayerTank.h"
+#include "Projectile.h"
+#include "TankArchetype.h"
+#include "Engine/Engine.h"
+#include "Engine/World.h"
+#include "Engine/GameViewportClient.h"
+#include "GameFramework/PlayerController.h"
+#include "GameFramework/InputSettings.h"
+#include "Framework/Application/SlateApplication.h"
+
+namespace
+{
+    // Shared between the test body and the latent command that drives the game frames
+    struct FFireLatencyState
+    {
+        FAutomationTestBase* Test = nullptr;
+        TWeakObjectPtr<UWorld> World;
+        TWeakObjectPtr<APlayerController> PlayerController;
+        TWeakObjectPtr<APawn> PreviousPawn;
+        TWeakObjectPtr<APlayerTank> Tank;
+        FInputActionKeyMapping AddedMapping;
+        bool bAddedMapping = false;
+        FKey FireKey;
+        float ReadyTime = 0.0f;
+
+        int32 WorldTicks = 0;
+        int32 TicksAtKey = INDEX_NONE;
+        int32 TicksAtSpawn = INDEX_NONE;
+        double KeyTime = 0.0;
+        double SpawnTime = 0.0;
+
+        FDelegateHandle TickHandle;
+        FDelegateHandle SpawnHandle;
+    };
+
+    // Ticks to wait for the shot before giving up, well past the one-tick bound
+    constexpr int32 MaxWaitTicks = 10;
+
+    void FinishFireLatencyTest(FFireLatencyState& State)
+    {
+        FWorldDelegates::OnWorldTickStart.Remove(State.TickHandle);
+        if (UWorld* World = State.World.Get())
+        {
+            World->RemoveOnActorSpawnedHandler(State.SpawnHandle);
+        }
+
+        if (FSlateApplication::IsInitialized() && State.TicksAtKey != INDEX_NONE)
+        {
+            FSlateApplication::Get().ProcessKeyUpEvent(FKeyEvent(State.FireKey, FModifierKeysState(), 0, false, 0, 0));
+        }
+
+        if (APlayerController* PlayerController = State.PlayerController.Get())
+        {
+            PlayerController->UnPossess();
+            if (APawn* PreviousPawn = State.PreviousPawn.Get())
+            {
+                PlayerController->Possess(PreviousPawn);
+            }
+        }
+
+        if (APlayerTank* Tank = State.Tank.Get())
+        {
+            Tank->Destroy();
+        }
+
+        if (State.bAddedMapping)
+        {
+            UInputSettings::GetInputSettings()->RemoveActionMapping(State.AddedMapping);
+        }
+    }
+}
+
+DEFINE_LATENT_AUTOMATION_COMMAND_ONE_PARAMETER(FWaitForTankShotCommand, TSharedRef<FFireLatencyState>, State);
 
-FVector APlayerTank::GetMouseHitLocation()
+bool FWaitForTankShotCommand::Update()
 {
-    FHitResult HitResult;
-    if (PlayerControllerRef)
+    UWorld* World = State->World.Get();
+    if (!World || !State->Tank.IsValid())
     {
-        PlayerControllerRef->GetHitResultUnderCursor(
-            ECollisionChannel::ECC_Visibility, false, HitResult);
-        return HitResult.Location;
+        State->Test->AddError(TEXT("The game world or the test tank went away"));
+        FinishFireLatencyTest(*State);
+        return true;
     }
-    return FVector::ZeroVector;
+
+    if (State->TicksAtKey == INDEX_NONE)
+    {
+        // Let the tank tick once and wait out its fire cooldown, so the press is the
+        // only thing gating the shot
+        if (State->WorldTicks < 1 || World->GetTimeSeconds() < State->ReadyTime) return false;
+
+        // Route the press the way a real key arrives: Slate, the game viewport, then the
+        // player controller's input stack
+        FSlateApplication::Get().SetAllUserFocusToGameViewport();
+        State->TicksAtKey = State->WorldTicks;
+        State->KeyTime = FPlatformTime::Seconds();
+        FSlateApplication::Get().ProcessKeyDownEvent(FKeyEvent(State->FireKey, FModifierKeysState(), 0, false, 0, 0));
+        return false;
+    }
+
+    if (State->TicksAtSpawn == INDEX_NONE)
+    {
+        if (State->WorldTicks - State->TicksAtKey <= MaxWaitTicks) return false;
+
+        State->Test->AddError(FString::Printf(TEXT("No projectile spawned within %d world ticks of the fire key"), MaxWaitTicks));
+        FinishFireLatencyTest(*State);
+        return true;
+    }
+
+    int32 TicksToSpawn = State->TicksAtSpawn - State->TicksAtKey;
+    State->Test->AddInfo(FString::Printf(TEXT("Fire key to projectile spawn: %d world tick(s), %.2f ms"),
+                                         TicksToSpawn, (State->SpawnTime - State->KeyTime) * 1000.0));
+    State->Test->TestTrue(TEXT("Projectile spawns in the first world tick after the fire key"), TicksToSpawn <= 1);
+
+    FinishFireLatencyTest(*State);
+    return true;
 }
 
-void APlayerTank::HandleDestruction()
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FPlayerTankFireInputLatencyTest, "TankBattle.Input.FireInputToSpawnLatency",
+    EAutomationTestFlags::ClientContext | EAutomationTestFlags::EngineFilter)
+
+bool FPlayerTankFireInputLatencyTest::RunTest(const FString& Parameters)
 {
-    Super::HandleDestruction();
-    SetActorHiddenInGame(true);
-    SetActorTickEnabled(false);
+    UGameViewportClient* GameViewport = GEngine ? GEngine->GameViewport : nullptr;
+    UWorld* World = GameViewport ? GameViewport->GetWorld() : nullptr;
+    APlayerController* PlayerController = World ? World->GetFirstPlayerController() : nullptr;
+    if (!FSlateApplication::IsInitialized() || !PlayerController || !World->HasBegunPlay())
+    {
+        AddError(TEXT("Needs a running game with a local player, run it in a -game session"));
+        return false;
+    }
+
+    TSharedRef<FFireLatencyState> State = MakeShared<FFireLatencyState>();
+    State->Test = this;
+    State->World = World;
+    State->PlayerController = PlayerController;
+    State->PreviousPawn = PlayerController->GetPawn();
+
+    // Press whatever key Fire is bound to, binding one for the test if needed
+    UInputSettings* Settings = UInputSettings::GetInputSettings();
+    TArray<FInputActionKeyMapping> FireMappings;
+    Settings->GetActionMappingByName("Fire", FireMappings);
+    if (FireMappings.Num() == 0)
+    {
+        State->AddedMapping = FInputActionKeyMapping("Fire", EKeys::SpaceBar);
+        State->bAddedMapping = true;
+        Settings->AddActionMapping(State->AddedMapping);
+        FireMappings.Add(State->AddedMapping);
+    }
+    State->FireKey = FireMappings[0].Key;
+
+    UTankArchetype* Archetype = NewObject<UTankArchetype>(GetTransientPackage());
+    Archetype->ProjectileClass = AProjectile::StaticClass();
+    State->ReadyTime = 1.0f / Archetype->FireRate;
+
+    // Far above the level so the shot hits nothing
+    FTransform SpawnTransform(FVector(0.0f, 0.0f, 100000.0f));
+    APlayerTank* Tank = World->SpawnActorDeferred<APlayerTank>(APlayerTank::StaticClass(), SpawnTransform,
+                                                               nullptr, nullptr, ESpawnActorCollisionHandlingMethod::AlwaysSpawn);
+    FindFProperty<FObjectProperty>(ATankBase::StaticClass(), TEXT("Archetype"))->SetObjectPropertyValue_InContainer(Tank, Archetype);
+    Tank->FinishSpawning(SpawnTransform);
+    State->Tank = Tank;
+
+    PlayerController->Possess(Tank);
+    PlayerController->SetInputMode(FInputModeGameOnly());
+
+    FFireLatencyState* StatePtr = &State.Get();
+    State->TickHandle = FWorldDelegates::OnWorldTickStart.AddLambda([StatePtr](UWorld* TickedWorld, ELevelTick, float)
+    {
+        if (TickedWorld == StatePtr->World.Get())
+        {
+            ++StatePtr->WorldTicks;
+        }
+    });
+    State->SpawnHandle = World->AddOnActorSpawnedHandler(FOnActorSpawned::FDelegate::CreateLambda([StatePtr](AActor* Actor)
+    {
+        if (StatePtr->TicksAtSpawn == INDEX_NONE && StatePtr->TicksAtKey != INDEX_NONE
+            && Actor->IsA<AProjectile>() && Actor->GetOwner() == StatePtr->Tank.Get())
+        {
+            StatePtr->TicksAtSpawn = StatePtr->WorldTicks;
+            StatePtr->SpawnTime = FPlatformTime::Seconds();
+        }
+    }));
+
+    ADD_LATENT_AUTOMATION_COMMAND(FWaitForTankShotCommand(State));
+    return true;
 }
 
+#endif // WITH_DEV_AUTOMATION_TESTS
+
 // EnemyTank.h - AI-controlled enemy tank
 #pragma once
 
@@ -340,22 +1572,26 @@ class TANKBATTLE_API AEnemyTank : public ATankBase
 public:
     AEnemyTank();
 
+    // AI ranges come from the tank archetype, the current state from the state store.
+    // Replaces the CurrentState property Blueprints used to read directly.
+    UFUNCTION(BlueprintPure, Category = "AI")
+    EAIState GetAIState() const;
+
 protected:
     virtual void BeginPlay() override;
     virtual void Tick(float DeltaTime) override;
 
-    // AI Properties
-    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "AI")
+    // Legacy per-instance AI tuning, only used when no Archetype is set
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "AI|Legacy", meta = (EditCondition = "Archetype == nullptr", DeprecatedProperty, DeprecationMessage = "Set AI ranges on a TankArchetype asset; this field is only read at BeginPlay when no Archetype is set."))
     float DetectionRange = 1500.0f;
 
-    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "AI")
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "AI|Legacy", meta = (EditCondition = "Archetype == nullptr", DeprecatedProperty, DeprecationMessage = "Set AI ranges on a TankArchetype asset; this field is only read at BeginPlay when no Archetype is set."))
     float AttackRange = 800.0f;
 
-    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "AI")
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "AI|Legacy", meta = (EditCondition = "Archetype == nullptr", DeprecatedProperty, DeprecationMessage = "Set AI ranges on a TankArchetype asset; this field is only read at BeginPlay when no Archetype is set."))
     float PatrolRadius = 1000.0f;
 
-    UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "AI")
-    EAIState CurrentState = EAIState::Idle;
+    virtual void CopyLegacyTuning(UTankArchetype& OutArchetype) const override;
 
     // AI Components
     UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "AI")
@@ -382,6 +1618,7 @@ private:
     void MoveToTarget(FVector TargetLocation);
     void FireAtPlayer();
     FVector GetRandomPatrolPoint();
+    void SetAIState(EAIState NewState);
     
     virtual void HandleDestruction() override;
 };
@@ -389,6 +1626,9 @@ private:
 // EnemyTank.cpp
 #include "EnemyTank.h"
 #include "PlayerTank.h"
+#include "TankArchetype.h"
+#include "TankStateSubsystem.h"
+#include "TankTelemetry.h"
 #include "AIController.h"
 #include "NavigationSystem.h"
 #include "NavigationPath.h"
@@ -409,13 +1649,16 @@ void AEnemyTank::BeginPlay()
     PlayerTank = Cast<APlayerTank>(UGameplayStatics::GetPlayerPawn(this, 0));
     InitialLocation = GetActorLocation();
     CurrentPatrolTarget = GetRandomPatrolPoint();
+    
+    FTankTelemetry::Emit(ETelemetryEventType::AIStateChange, GetWorld(), GetWorld()->GetTimeSeconds(),
+                         this, nullptr, 0.0f, (uint8)GetAIState());
 }
 
 void AEnemyTank::Tick(float DeltaTime)
 {
     Super::Tick(DeltaTime);
     
-    if (!IsDestroyed())
+    if (!IsDestroyed() && HasTankState())
     {
         UpdateAIState();
         ExecuteAIBehavior();
@@ -426,29 +1669,52 @@ void AEnemyTank::UpdateAIState()
 {
     if (!PlayerTank || PlayerTank->IsDestroyed())
     {
-        CurrentState = EAIState::Patrolling;
+        SetAIState(EAIState::Patrolling);
         return;
     }
     
     float DistanceToPlayer = FVector::Dist(GetActorLocation(), PlayerTank->GetActorLocation());
+    const UTankArchetype& Stats = GetArchetype();
     
-    if (DistanceToPlayer <= AttackRange)
+    if (DistanceToPlayer <= Stats.AttackRange)
     {
-        CurrentState = EAIState::Attacking;
+        SetAIState(EAIState::Attacking);
     }
-    else if (DistanceToPlayer <= DetectionRange)
+    else if (DistanceToPlayer <= Stats.DetectionRange)
     {
-        CurrentState = EAIState::Chasing;
+        SetAIState(EAIState::Chasing);
     }
     else
     {
-        CurrentState = EAIState::Patrolling;
+        SetAIState(EAIState::Patrolling);
     }
 }
 
+void AEnemyTank::CopyLegacyTuning(UTankArchetype& OutArchetype) const
+{
+    Super::CopyLegacyTuning(OutArchetype);
+    OutArchetype.DetectionRange = DetectionRange;
+    OutArchetype.AttackRange = AttackRange;
+    OutArchetype.PatrolRadius = PatrolRadius;
+}
+
+EAIState AEnemyTank::GetAIState() const
+{
+    return HasTankState() ? (EAIState)TankStates->AIStates[StateIndex] : EAIState::Idle;
+}
+
+void AEnemyTank::SetAIState(EAIState NewState)
+{
+    if (!HasTankState() || NewState == GetAIState()) return;
+    
+    TankStates->AIStates[StateIndex] = (uint8)NewState;
+    FTankTelemetry::Emit(ETelemetryEventType::AIStateChange, GetWorld(), GetWorld()->GetTimeSeconds(),
+                         this, nullptr, 0.0f, (uint8)NewState);
+}
+
 void AEnemyTank::ExecuteAIBehavior()
 {
-    switch (CurrentState)
+    switch (GetAIState())
     {
         case EAIState::Idle:
             HandleIdleState();
@@ -542,7 +1808,7 @@ FVector AEnemyTank::GetRandomPatrolPoint()
     {
         FNavLocation RandomLocation;
         if (NavSystem->GetRandomReachablePointInRadius(
-            InitialLocation, PatrolRadius, RandomLocation))
+            InitialLocation, GetArchetype().PatrolRadius, RandomLocation))
         {
             return RandomLocation.Location;
         }
@@ -562,6 +1828,7 @@ void AEnemyTank::HandleDestruction()
 
 #include "CoreMinimal.h"
 #include "GameFramework/Actor.h"
+#include "TankBattleGlobals.h"
 #include "Projectile.generated.h"
 
 UCLASS()
@@ -574,18 +1841,19 @@ public:
 
 protected:
     virtual void BeginPlay() override;
+    virtual void PreRegisterAllComponents() override;
 
     UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Components")
     class USphereComponent* CollisionSphere;
 
     UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Components")
-    class UStaticMeshComponent* ProjectileMesh;
+    class UTankCosmeticMeshComponent* ProjectileMesh;
 
     UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Components")
     class UProjectileMovementComponent* ProjectileMovement;
 
     UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Components")
-    class UParticleSystemComponent* TrailParticles;
+    class UTankTrailComponent* TrailParticles;
 
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Combat")
     float Damage = 25.0f;
@@ -593,24 +1861,40 @@ protected:
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Combat")
     float LifeSpan = 3.0f;
 
+    // Explosive shells damage everything within this radius; 0 hits only the struck actor
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Combat")
+    float SplashRadius = 0.0f;
+
+    // Exponent of the damage falloff from the center to the edge of the splash radius
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Combat")
+    float SplashFalloff = 1.0f;
+
+    // Whether the firing tank takes damage from its own splash
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Combat")
+    bool bSplashDamagesOwner = false;
+
 private:
     UFUNCTION()
     void OnHit(UPrimitiveComponent* HitComp, AActor* OtherActor, 
               UPrimitiveComponent* OtherComp, FVector NormalImpulse, 
               const FHitResult& Hit);
 
-public:    
+public:
     virtual void Tick(float DeltaTime) override;
+    void CatchUp(float ElapsedTime);
 };
 
 // Projectile.cpp
 #include "Projectile.h"
 #include "Components/SphereComponent.h"
-#include "Components/StaticMeshComponent.h"
 #include "GameFramework/ProjectileMovementComponent.h"
-#include "Particles/ParticleSystemComponent.h"
+#include "TankCosmeticComponents.h"
 #include "Kismet/GameplayStatics.h"
 #include "GameFramework/DamageType.h"
+#include "TankTelemetry.h"
+#include "TankBase.h"
+#include "Obstacle.h"
+#include "SplashDamageSubsystem.h"
 
 AProjectile::AProjectile()
 {
@@ -624,21 +1908,33 @@ AProjectile::AProjectile()
     CollisionSphere->SetCollisionResponseToAllChannels(ECR_Block);
     CollisionSphere->SetCollisionResponseToChannel(ECC_Pawn, ECR_Ignore);
 
-    // Projectile mesh
-    ProjectileMesh = CreateDefaultSubobject<UStaticMeshComponent>(TEXT("ProjectileMesh"));
+#if !UE_SERVER
+    // Projectile mesh and trail are purely visual, collision lives on the sphere
+    ProjectileMesh = CreateDefaultSubobject<UTankCosmeticMeshComponent>(TEXT("ProjectileMesh"));
     ProjectileMesh->SetupAttachment(CollisionSphere);
     ProjectileMesh->SetCollisionEnabled(ECollisionEnabled::NoCollision);
 
+    TrailParticles = CreateDefaultSubobject<UTankTrailComponent>(TEXT("TrailParticles"));
+    TrailParticles->SetupAttachment(RootComponent);
+#endif
+
     // Movement component
     ProjectileMovement = CreateDefaultSubobject<UProjectileMovementComponent>(TEXT("ProjectileMovement"));
     ProjectileMovement->InitialSpeed = 2000.0f;
     ProjectileMovement->MaxSpeed = 2000.0f;
     ProjectileMovement->bShouldBounce = false;
     ProjectileMovement->ProjectileGravityScale = 0.0f;
+}
 
-    // Trail particles
-    TrailParticles = CreateDefaultSubobject<UParticleSystemComponent>(TEXT("TrailParticles"));
-    TrailParticles->SetupAttachment(RootComponent);
+void AProjectile::PreRegisterAllComponents()
+{
+    if (TankBattle::ShouldSkipEffects() && GetWorld() && GetWorld()->IsGameWorld())
+    {
+        TankBattle::StripCosmeticComponent(TrailParticles);
+        TankBattle::StripCosmeticComponent(ProjectileMesh);
+    }
+    
+    Super::PreRegisterAllComponents();
 }
 
 void AProjectile::BeginPlay()
@@ -658,17 +1954,38 @@ void AProjectile::OnHit(UPrimitiveComponent* HitComp, AActor* OtherActor,
     
     if (OtherActor && OtherActor != this && OtherActor != MyOwner)
     {
+        ETelemetryTargetKind TargetKind = OtherActor->IsA<ATankBase>() ? ETelemetryTargetKind::Tank
+            : OtherActor->IsA<AObstacle>() ? ETelemetryTargetKind::Obstacle : ETelemetryTargetKind::Other;
+        FTankTelemetry::Emit(ETelemetryEventType::Hit, GetWorld(), GetWorld()->GetTimeSeconds(),
+                             MyOwner, OtherActor, Damage, (uint8)TargetKind);
+        
         UGameplayStatics::ApplyPointDamage(
             OtherActor, Damage, GetActorLocation(), 
             Hit, nullptr, this, UDamageType::StaticClass());
         
-        // Spawn explosion effect
-        UGameplayStatics::SpawnEmitterAtLocation(
-            GetWorld(), nullptr, GetActorLocation());
+        if (SplashRadius > 0.0f)
+        {
+            // Resolved with every other explosion this frame. The struck actor already
+            // took the direct hit, so the splash only reaches everything around it.
+            FSplashExplosion Explosion{ GetActorLocation(), SplashRadius, Damage, SplashFalloff,
+                                        MyOwner, MyOwner->GetInstigatorController(), { OtherActor } };
+            if (!bSplashDamagesOwner)
+            {
+                Explosion.IgnoredActors.Add(MyOwner);
+            }
+            GetWorld()->GetSubsystem<USplashDamageSubsystem>()->QueueExplosion(Explosion);
+        }
         
-        // Play explosion sound
-        UGameplayStatics::PlaySoundAtLocation(
-            GetWorld(), nullptr, GetActorLocation());
+        if (!TankBattle::ShouldSkipEffects())
+        {
+            // Spawn explosion effect
+            UGameplayStatics::SpawnEmitterAtLocation(
+                GetWorld(), nullptr, GetActorLocation());
+            
+            // Play explosion sound
+            UGameplayStatics::PlaySoundAtLocation(
+                GetWorld(), nullptr, GetActorLocation());
+        }
         
         Destroy();
     }
@@ -679,11 +1996,24 @@ void AProjectile::Tick(float DeltaTime)
     Super::Tick(DeltaTime);
 }
 
+void AProjectile::CatchUp(float ElapsedTime)
+{
+    if (ElapsedTime <= 0.0f) return;
+    
+    // A shot fired earlier in the frame expires as if it had been spawned on time
+    SetLifeSpan(FMath::Max(LifeSpan - ElapsedTime, KINDA_SMALL_NUMBER));
+    
+    // Sweep to where the shot would be by now, so anything between the muzzle
+    // and that point is still hit through OnHit
+    AddActorWorldOffset(ProjectileMovement->Velocity * ElapsedTime, true);
+}
+
 // Obstacle.h - Destructible obstacles
 #pragma once
 
 #include "CoreMinimal.h"
 #include "GameFramework/Actor.h"
+#include "TankBattleGlobals.h"
 #include "Obstacle.generated.h"
 
 UENUM(BlueprintType)
@@ -724,13 +2054,22 @@ protected:
     UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Obstacle")
     float CurrentHealth;
 
+    // Explosive obstacles (fuel drums, ammo dumps) splash when destroyed
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Obstacle")
+    float ExplosionRadius = 0.0f;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Obstacle")
+    float ExplosionDamage = 0.0f;
+
     virtual float TakeDamage(float DamageAmount, struct FDamageEvent const& DamageEvent,
                             class AController* EventInstigator, AActor* DamageCauser) override;
 
-    void DestroyObstacle();
+    // Instigator and causer of the killing blow, credited with any chained explosion
+    void DestroyObstacle(AController* EventInstigator, AActor* DamageCauser);
 
 public:    
     virtual void Tick(float DeltaTime) override;
+    bool IsDestructible() const { return bIsDestructible; }
 };
 
 // Obstacle.cpp
@@ -738,6 +2077,8 @@ public:
 #include "Components/BoxComponent.h"
 #include "Components/StaticMeshComponent.h"
 #include "Kismet/GameplayStatics.h"
+#include "TankTelemetry.h"
+#include "SplashDamageSubsystem.h"
 
 AObstacle::AObstacle()
 {
@@ -768,19 +2109,35 @@ float AObstacle::TakeDamage(float DamageAmount, FDamageEvent const& DamageEvent,
     
     CurrentHealth = FMath::Clamp(CurrentHealth - ActualDamage, 0.0f, MaxHealth);
     
+    FTankTelemetry::Emit(ETelemetryEventType::Damage, GetWorld(), GetWorld()->GetTimeSeconds(),
+                         DamageCauser, this, ActualDamage);
+    
     if (CurrentHealth <= 0)
     {
-        DestroyObstacle();
+        DestroyObstacle(EventInstigator, DamageCauser);
     }
     
     return ActualDamage;
 }
 
-void AObstacle::DestroyObstacle()
+void AObstacle::DestroyObstacle(AController* EventInstigator, AActor* DamageCauser)
 {
+    FTankTelemetry::Emit(ETelemetryEventType::ObstacleDestroyed, GetWorld(), GetWorld()->GetTimeSeconds(),
+                         nullptr, this, 0.0f, (uint8)ObstacleType);
+    
+    // Chained explosions are resolved by the splash subsystem in its next wave
+    if (ExplosionRadius > 0.0f && ExplosionDamage > 0.0f)
+    {
+        GetWorld()->GetSubsystem<USplashDamageSubsystem>()->QueueExplosion(
+            { GetActorLocation(), ExplosionRadius, ExplosionDamage, 1.0f, DamageCauser, EventInstigator, { this } });
+    }
+    
     // Spawn destruction effects
-    UGameplayStatics::SpawnEmitterAtLocation(GetWorld(), nullptr, GetActorLocation());
-    UGameplayStatics::PlaySoundAtLocation(GetWorld(), nullptr, GetActorLocation());
+    if (!TankBattle::ShouldSkipEffects())
+    {
+        UGameplayStatics::SpawnEmitterAtLocation(GetWorld(), nullptr, GetActorLocation());
+        UGameplayStatics::PlaySoundAtLocation(GetWorld(), nullptr, GetActorLocation());
+    }
     
     Destroy();
 }
@@ -789,3 +2146,491 @@ void AObstacle::Tick(float DeltaTime)
 {
     Super::Tick(DeltaTime);
 }
+
+// SplashDamageSubsystem.h - Batched radial damage for explosive shells
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "SplashDamageSubsystem.generated.h"
+
+struct FSplashExplosion
+{
+    FVector Location;
+    float Radius;
+    float Damage;
+    float Falloff;
+    TWeakObjectPtr<AActor> DamageCauser;
+    TWeakObjectPtr<AController> EventInstigator;
+
+    // Actors this explosion never damages; compared by address only, never dereferenced
+    TArray<const AActor*, TInlineAllocator<2>> IgnoredActors;
+};
+
+// Uniform grid over target positions, resolves many explosions in one pass
+class FSplashDamageResolver
+{
+public:
+    // TargetActors is parallel to the locations and may be empty when no explosion
+    // ignores anything
+    void Build(TArrayView<const FVector> InTargetLocations, TArrayView<const AActor* const> InTargetActors,
+               float InCellSize);
+
+    // Adds the falloff damage of every explosion to the targets it reaches. OutSource
+    // receives the index of the first explosion that reached each target.
+    void Accumulate(TArrayView<const FSplashExplosion> Explosions,
+                    TArray<float>& OutDamage, TArray<int32>& OutSource) const;
+
+    float GetCellSize() const { return CellSize; }
+
+private:
+    FIntPoint GetCell(const FVector& Location) const;
+
+    TArray<FVector> TargetLocations;
+    TArray<const AActor*> TargetActors;
+    TMap<FIntPoint, TArray<int32, TInlineAllocator<4>>> Cells;
+    float CellSize = 0.0f;
+};
+
+UCLASS()
+class TANKBATTLE_API USplashDamageSubsystem : public UTickableWorldSubsystem
+{
+    GENERATED_BODY()
+
+public:
+    // Explosions are resolved together at the next subsystem tick
+    void QueueExplosion(const FSplashExplosion& Explosion);
+
+    virtual void Tick(float DeltaTime) override;
+    virtual TStatId GetStatId() const override;
+
+private:
+    // Chained explosions beyond this many waves carry over to the next frame
+    static constexpr int32 MaxChainWaves = 16;
+
+    TArray<FSplashExplosion> PendingExplosions;
+};
+
+// SplashDamageSubsystem.cpp
+#include "SplashDamageSubsystem.h"
+#include "TankBase.h"
+#include "TankStateSubsystem.h"
+#include "Obstacle.h"
+#include "EngineUtils.h"
+#include "Kismet/GameplayStatics.h"
+#include "GameFramework/DamageType.h"
+#include "HAL/IConsoleManager.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogSplashDamage, Log, All);
+
+void FSplashDamageResolver::Build(TArrayView<const FVector> InTargetLocations,
+                                  TArrayView<const AActor* const> InTargetActors, float InCellSize)
+{
+    TargetLocations.Reset();
+    TargetLocations.Append(InTargetLocations.GetData(), InTargetLocations.Num());
+    TargetActors.Reset();
+    TargetActors.Append(InTargetActors.GetData(), InTargetActors.Num());
+    CellSize = FMath::Max(InCellSize, 1.0f);
+    Cells.Reset();
+
+    for (int32 Index = 0; Index < TargetLocations.Num(); ++Index)
+    {
+        Cells.FindOrAdd(GetCell(TargetLocations[Index])).Add(Index);
+    }
+}
+
+void FSplashDamageResolver::Accumulate(TArrayView<const FSplashExplosion> Explosions,
+                                       TArray<float>& OutDamage, TArray<int32>& OutSource) const
+{
+    OutDamage.Init(0.0f, TargetLocations.Num());
+    OutSource.Init(INDEX_NONE, TargetLocations.Num());
+
+    for (int32 ExplosionIndex = 0; ExplosionIndex < Explosions.Num(); ++ExplosionIndex)
+    {
+        const FSplashExplosion& Explosion = Explosions[ExplosionIndex];
+        if (Explosion.Radius <= 0.0f) continue;
+
+        FVector Extent(Explosion.Radius, Explosion.Radius, 0.0f);
+        FIntPoint MinCell = GetCell(Explosion.Location - Extent);
+        FIntPoint MaxCell = GetCell(Explosion.Location + Extent);
+        float RadiusSquared = FMath::Square(Explosion.Radius);
+
+        for (int32 X = MinCell.X; X <= MaxCell.X; ++X)
+        {
+            for (int32 Y = MinCell.Y; Y <= MaxCell.Y; ++Y)
+            {
+                const auto* Cell = Cells.Find(FIntPoint(X, Y));
+                if (!Cell) continue;
+
+                for (int32 TargetIndex : *Cell)
+                {
+                    float DistanceSquared = FVector::DistSquared(Explosion.Location, TargetLocations[TargetIndex]);
+                    if (DistanceSquared > RadiusSquared) continue;
+
+                    if (Explosion.IgnoredActors.Num() > 0 && TargetActors.IsValidIndex(TargetIndex)
+                        && Explosion.IgnoredActors.Contains(TargetActors[TargetIndex]))
+                    {
+                        continue;
+                    }
+
+                    float Alpha = 1.0f - FMath::Sqrt(DistanceSquared) / Explosion.Radius;
+                    OutDamage[TargetIndex] += Explosion.Damage * FMath::Pow(Alpha, Explosion.Falloff);
+
+                    if (OutSource[TargetIndex] == INDEX_NONE)
+                    {
+                        OutSource[TargetIndex] = ExplosionIndex;
+                    }
+                }
+            }
+        }
+    }
+}
+
+FIntPoint FSplashDamageResolver::GetCell(const FVector& Location) const
+{
+    return FIntPoint(FMath::FloorToInt(Location.X / CellSize), FMath::FloorToInt(Location.Y / CellSize));
+}
+
+void USplashDamageSubsystem::QueueExplosion(const FSplashExplosion& Explosion)
+{
+    PendingExplosions.Add(Explosion);
+}
+
+void USplashDamageSubsystem::Tick(float DeltaTime)
+{
+    if (PendingExplosions.Num() == 0) return;
+
+    // Snapshot every damageable target once for all waves this frame
+    TArray<const AActor*> Targets;
+    TArray<FVector> TargetLocations;
+
+    UTankStateSubsystem* TankStates = GetWorld()->GetSubsystem<UTankStateSubsystem>();
+    TankStates->RefreshPositions();
+    for (int32 Index = 0; Index < TankStates->Num(); ++Index)
+    {
+        if (TankStates->CurrentHealth[Index] > 0.0f)
+        {
+            Targets.Add(TankStates->Tanks[Index]);
+            TargetLocations.Add(TankStates->Positions[Index]);
+        }
+    }
+
+    for (TActorIterator<AObstacle> It(GetWorld()); It; ++It)
+    {
+        if (It->IsDestructible())
+        {
+            Targets.Add(*It);
+            TargetLocations.Add(It->GetActorLocation());
+        }
+    }
+
+    FSplashDamageResolver Resolver;
+    TArray<FSplashExplosion> Wave;
+    TArray<float> Damage;
+    TArray<int32> Source;
+
+    // Obstacles destroyed by one wave queue their own explosions into the next,
+    // so chains unwind iteratively instead of through nested TakeDamage calls
+    for (int32 WaveIndex = 0; WaveIndex < MaxChainWaves && PendingExplosions.Num() > 0; ++WaveIndex)
+    {
+        Wave = MoveTemp(PendingExplosions);
+        PendingExplosions.Reset();
+
+        float MaxRadius = 0.0f;
+        for (const FSplashExplosion& Explosion : Wave)
+        {
+            MaxRadius = FMath::Max(MaxRadius, Explosion.Radius);
+        }
+
+        if (WaveIndex == 0 || MaxRadius > Resolver.GetCellSize())
+        {
+            Resolver.Build(TargetLocations, Targets, MaxRadius);
+        }
+
+        Resolver.Accumulate(Wave, Damage, Source);
+
+        for (int32 TargetIndex = 0; TargetIndex < Targets.Num(); ++TargetIndex)
+        {
+            if (Damage[TargetIndex] <= 0.0f || !IsValid(Targets[TargetIndex])) continue;
+
+            const FSplashExplosion& Explosion = Wave[Source[TargetIndex]];
+            UGameplayStatics::ApplyDamage(
+                const_cast<AActor*>(Targets[TargetIndex]), Damage[TargetIndex], Explosion.EventInstigator.Get(),
+                Explosion.DamageCauser.Get(), UDamageType::StaticClass());
+        }
+    }
+}
+
+TStatId USplashDamageSubsystem::GetStatId() const
+{
+    RETURN_QUICK_DECLARE_CYCLE_STAT(USplashDamageSubsystem, STATGROUP_Tickables);
+}
+
+// Times full subsystem ticks for 100 simultaneous explosions over 1000 freshly spawned
+// obstacles: the target snapshot, the batched resolve and every ApplyDamage call
+static FAutoConsoleCommandWithWorldAndArgs BenchSplashCommand(
+    TEXT("Tank.BenchSplash"),
+    TEXT("Tank.BenchSplash [Ticks] - Benchmarks splash damage ticks (100 explosions, 1000 obstacles)"),
+    FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World)
+    {
+        USplashDamageSubsystem* Splash = World ? World->GetSubsystem<USplashDamageSubsystem>() : nullptr;
+        if (!Splash || !World->HasBegunPlay())
+        {
+            UE_LOG(LogSplashDamage, Warning, TEXT("Tank.BenchSplash needs a game world that has begun play"));
+            return;
+        }
+
+        const int32 NumTargets = 1000;
+        const int32 NumExplosions = 100;
+        const int32 Ticks = Args.Num() > 0 ? FMath::Max(FCString::Atoi(*Args[0]), 1) : 10;
+        const float ArenaSize = 20000.0f;
+        const float Radius = 500.0f;
+        // Far above the level so the benchmark obstacles stay out of play
+        const float BenchHeight = 100000.0f;
+
+        FRandomStream Random(42);
+        FActorSpawnParameters SpawnParams;
+        SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+
+        TArray<AObstacle*> Obstacles;
+        double TotalTime = 0.0;
+        double MaxTime = 0.0;
+        int32 Destroyed = 0;
+
+        for (int32 Tick = 0; Tick < Ticks; ++Tick)
+        {
+            Obstacles.Reset();
+            for (int32 Index = 0; Index < NumTargets; ++Index)
+            {
+                FVector Location(Random.FRandRange(0.0f, ArenaSize), Random.FRandRange(0.0f, ArenaSize), BenchHeight);
+                Obstacles.Add(World->SpawnActor<AObstacle>(AObstacle::StaticClass(), Location, FRotator::ZeroRotator, SpawnParams));
+            }
+
+            for (int32 Index = 0; Index < NumExplosions; ++Index)
+            {
+                FVector Location(Random.FRandRange(0.0f, ArenaSize), Random.FRandRange(0.0f, ArenaSize), BenchHeight);
+                Splash->QueueExplosion({ Location, Radius, 50.0f, 1.0f, nullptr, nullptr, {} });
+            }
+
+            double StartTime = FPlatformTime::Seconds();
+            Splash->Tick(World->GetDeltaSeconds());
+            double Elapsed = FPlatformTime::Seconds() - StartTime;
+
+            TotalTime += Elapsed;
+            MaxTime = FMath::Max(MaxTime, Elapsed);
+
+            for (AObstacle* Obstacle : Obstacles)
+            {
+                if (!IsValid(Obstacle))
+                {
+                    ++Destroyed;
+                    continue;
+                }
+                Obstacle->Destroy();
+            }
+        }
+
+        UE_LOG(LogSplashDamage, Display,
+               TEXT("%d explosions over %d obstacles: %.3f ms mean, %.3f ms max per tick over %d ticks, %d obstacles destroyed per tick"),
+               NumExplosions, NumTargets, TotalTime * 1000.0 / Ticks, MaxTime * 1000.0, Ticks, Destroyed / Ticks);
+    }));
+
+// TankTelemetrySummaryCommandlet.h - Offline summary of a telemetry file
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "TankTelemetrySummaryCommandlet.generated.h"
+
+// Usage: UnrealEditor-Cmd TankBattle -run=TankTelemetrySummary -File=<path.tktm>
+UCLASS()
+class UTankTelemetrySummaryCommandlet : public UCommandlet
+{
+    GENERATED_BODY()
+
+public:
+    virtual int32 Main(const FString& Params) override;
+};
+
+// TankTelemetrySummaryCommandlet.cpp
+#include "TankTelemetrySummaryCommandlet.h"
+#include "TankTelemetry.h"
+#include "EnemyTank.h"
+#include "Misc/FileHelper.h"
+
+namespace
+{
+    template <typename T>
+    const T* ReadColumn(const TArray<uint8>& Data, int64& Offset, uint32 Count)
+    {
+        int64 Size = (int64)Count * sizeof(T);
+        if (Offset + Size > Data.Num()) return nullptr;
+
+        const T* Column = reinterpret_cast<const T*>(Data.GetData() + Offset);
+        Offset += Size;
+        return Column;
+    }
+}
+
+int32 UTankTelemetrySummaryCommandlet::Main(const FString& Params)
+{
+    FString FilePath;
+    if (!FParse::Value(*Params, TEXT("File="), FilePath))
+    {
+        UE_LOG(LogTankTelemetry, Error, TEXT("Missing -File=<telemetry file>"));
+        return 1;
+    }
+
+    TArray<uint8> Data;
+    if (!FFileHelper::LoadFileToArray(Data, *FilePath) || Data.Num() < 8)
+    {
+        UE_LOG(LogTankTelemetry, Error, TEXT("Could not read %s"), *FilePath);
+        return 1;
+    }
+
+    int64 Offset = 0;
+    const uint32* Header = ReadColumn<uint32>(Data, Offset, 2);
+    if (Header[0] != FTelemetryWriter::FileMagic || Header[1] != FTelemetryWriter::FileVersion)
+    {
+        UE_LOG(LogTankTelemetry, Error, TEXT("%s is not a telemetry file"), *FilePath);
+        return 1;
+    }
+
+    struct FStateTrack
+    {
+        uint8 State;
+        float EnteredAt;
+    };
+
+    // Actors are keyed together with their world, since times from different worlds
+    // (a PIE server and its clients) run on unrelated clocks
+    auto MakeKey = [](uint32 WorldId, uint32 ActorId)
+    {
+        return ((uint64)WorldId << 32) | ActorId;
+    };
+
+    uint64 Shots = 0;
+    uint64 Impacts = 0;
+    uint64 Hits = 0;
+    uint64 Kills = 0;
+    uint64 ObstaclesDestroyed = 0;
+    uint64 Dropped = 0;
+    TMap<uint32, float> LastTimes;
+    TMap<uint64, float> FirstDamageTime;
+    TArray<float> TimesToKill;
+    TMap<uint64, FStateTrack> StateTracks;
+    TMap<uint8, double> StateDurations;
+
+    auto CloseState = [&StateTracks, &StateDurations](uint64 Id, float Time)
+    {
+        if (FStateTrack* Track = StateTracks.Find(Id))
+        {
+            StateDurations.FindOrAdd(Track->State) += Time - Track->EnteredAt;
+            StateTracks.Remove(Id);
+        }
+    };
+
+    while (Offset < Data.Num())
+    {
+        const uint32* Count = ReadColumn<uint32>(Data, Offset, 1);
+        const uint64* DroppedSoFar = Count ? ReadColumn<uint64>(Data, Offset, 1) : nullptr;
+        if (!DroppedSoFar) break;
+
+        uint32 N = *Count;
+        const float* Times = ReadColumn<float>(Data, Offset, N);
+        const uint32* WorldIds = ReadColumn<uint32>(Data, Offset, N);
+        const uint32* SourceIds = ReadColumn<uint32>(Data, Offset, N);
+        const uint32* TargetIds = ReadColumn<uint32>(Data, Offset, N);
+        const float* Values = ReadColumn<float>(Data, Offset, N);
+        const uint8* Types = ReadColumn<uint8>(Data, Offset, N);
+        const uint8* Details = ReadColumn<uint8>(Data, Offset, N);
+        if (!Details)
+        {
+            UE_LOG(LogTankTelemetry, Warning, TEXT("Truncated block at offset %lld"), Offset);
+            break;
+        }
+
+        Dropped = *DroppedSoFar;
+
+        for (uint32 Index = 0; Index < N; ++Index)
+        {
+            float Time = Times[Index];
+            uint32 WorldId = WorldIds[Index];
+            float& LastTime = LastTimes.FindOrAdd(WorldId, 0.0f);
+            LastTime = FMath::Max(LastTime, Time);
+            uint64 SourceKey = MakeKey(WorldId, SourceIds[Index]);
+            uint64 TargetKey = MakeKey(WorldId, TargetIds[Index]);
+
+            switch ((ETelemetryEventType)Types[Index])
+            {
+                case ETelemetryEventType::ShotFired:
+                    ++Shots;
+                    break;
+                case ETelemetryEventType::Hit:
+                    ++Impacts;
+                    if ((ETelemetryTargetKind)Details[Index] == ETelemetryTargetKind::Tank)
+                    {
+                        ++Hits;
+                    }
+                    break;
+                case ETelemetryEventType::Damage:
+                    if (Values[Index] > 0.0f)
+                    {
+                        FirstDamageTime.FindOrAdd(TargetKey, Time);
+                    }
+                    break;
+                case ETelemetryEventType::Kill:
+                    ++Kills;
+                    if (float* FirstHit = FirstDamageTime.Find(TargetKey))
+                    {
+                        TimesToKill.Add(Time - *FirstHit);
+                        FirstDamageTime.Remove(TargetKey);
+                    }
+                    CloseState(TargetKey, Time);
+                    break;
+                case ETelemetryEventType::ObstacleDestroyed:
+                    ++ObstaclesDestroyed;
+                    break;
+                case ETelemetryEventType::AIStateChange:
+                    CloseState(SourceKey, Time);
+                    StateTracks.Add(SourceKey, { Details[Index], Time });
+                    break;
+            }
+        }
+    }
+
+    // Tanks still alive at the end of the match, closed at the last time seen in their world
+    TArray<uint64> OpenTracks;
+    StateTracks.GetKeys(OpenTracks);
+    for (uint64 Id : OpenTracks)
+    {
+        CloseState(Id, LastTimes.FindRef((uint32)(Id >> 32)));
+    }
+
+    UE_LOG(LogTankTelemetry, Display, TEXT("Worlds: %d"), LastTimes.Num());
+    UE_LOG(LogTankTelemetry, Display, TEXT("Shots: %llu  Impacts: %llu  Tank hits: %llu  Hit rate: %.1f%%"),
+           Shots, Impacts, Hits, Shots > 0 ? 100.0 * Hits / Shots : 0.0);
+    UE_LOG(LogTankTelemetry, Display, TEXT("Kills: %llu  Obstacles destroyed: %llu  Dropped events: %llu"),
+           Kills, ObstaclesDestroyed, Dropped);
+
+    if (TimesToKill.Num() > 0)
+    {
+        TimesToKill.Sort();
+        float Total = 0.0f;
+        for (float TimeToKill : TimesToKill)
+        {
+            Total += TimeToKill;
+        }
+        UE_LOG(LogTankTelemetry, Display, TEXT("Time to kill: mean %.2fs  median %.2fs"),
+               Total / TimesToKill.Num(), TimesToKill[TimesToKill.Num() / 2]);
+    }
+
+    const UEnum* StateEnum = StaticEnum<EAIState>();
+    for (const TPair<uint8, double>& Duration : StateDurations)
+    {
+        UE_LOG(LogTankTelemetry, Display, TEXT("AI state %s: %.1fs"),
+               *StateEnum->GetDisplayNameTextByValue(Duration.Key).ToString(), Duration.Value);
+    }
+
+    return 0;
+}